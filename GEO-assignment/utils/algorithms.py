@@ -1,3 +1,4 @@
+from functools import lru_cache
 import numpy as np
 
 def de_casteljau(points, t):
@@ -20,3 +21,80 @@ def calc_tangent(points, t):
     diff_points = [np.subtract(points[i+1], points[i]) for i in range(n)]
     tangent, _ = de_casteljau(diff_points, t)
     return n * tangent
+
+def subdivide(points, t):
+    levels = [np.asarray(points, dtype=float)]
+    while len(levels[-1]) > 1:
+        pts = levels[-1]
+        levels.append((1 - t) * pts[:-1] + t * pts[1:])
+    left = np.array([level[0] for level in levels])
+    right = np.array([level[-1] for level in reversed(levels)])
+    return left, right
+
+def eval_bezier(points, ts):
+    ts = np.asarray(ts, dtype=float)[:, None, None]
+    pts = np.broadcast_to(np.asarray(points, dtype=float), (len(ts),) + np.shape(points))
+    while pts.shape[1] > 1:
+        pts = (1 - ts) * pts[:, :-1] + ts * pts[:, 1:]
+    return pts[:, 0]
+
+def reduce_to_cubic(points):
+    # a végpontok és a végponti deriváltak (n * (b1 - b0)) megmaradnak
+    pts = np.asarray(points, dtype=float)
+    n = len(pts) - 1
+    return np.array([pts[0],
+                     pts[0] + n / 3 * (pts[1] - pts[0]),
+                     pts[-1] - n / 3 * (pts[-1] - pts[-2]),
+                     pts[-1]])
+
+def eval_cubic(cubic, ts):
+    ts = np.asarray(ts, dtype=float)[:, None]
+    s = 1 - ts
+    return s**3 * cubic[0] + 3 * s**2 * ts * cubic[1] + 3 * s * ts**2 * cubic[2] + ts**3 * cubic[3]
+
+def cubic_derivative(cubic, ts):
+    ts = np.asarray(ts, dtype=float)[:, None]
+    s = 1 - ts
+    return 3 * (s**2 * (cubic[1] - cubic[0]) + 2 * s * ts * (cubic[2] - cubic[1]) + ts**2 * (cubic[3] - cubic[2]))
+
+@lru_cache(maxsize=1)
+def _approximate_cubics(points, tol, max_depth):
+    samples = np.linspace(0, 1, 9)[1:-1]
+    segments = []
+
+    def approximate(pts, t0, t1, depth):
+        cubic = reduce_to_cubic(pts)
+        if len(pts) > 4 and depth < max_depth:
+            error = np.linalg.norm(eval_bezier(pts, samples) - eval_cubic(cubic, samples), axis=1).max()
+            if error > tol:
+                left, right = subdivide(pts, 0.5)
+                mid = (t0 + t1) / 2
+                approximate(left, t0, mid, depth + 1)
+                approximate(right, mid, t1, depth + 1)
+                return
+        segments.append((t0, t1, cubic))
+
+    approximate(np.array(points, dtype=float), 0.0, 1.0, 0)
+    return tuple(segments)
+
+def approximate_cubics(points, tol=1e-3, max_depth=10):
+    # az eredmény addig marad cache-ben, amíg egy kontrollpont sem változik
+    return _approximate_cubics(tuple(map(tuple, points)), tol, max_depth)
+
+def _locate(segments, ts):
+    ends = np.array([t1 for _, t1, _ in segments])
+    return np.minimum(np.searchsorted(ends, ts), len(segments) - 1)
+
+def eval_cubics(segments, ts):
+    ts = np.asarray(ts, dtype=float)
+    idx = _locate(segments, ts)
+    result = np.empty((len(ts), 2))
+    for i in np.unique(idx):
+        t0, t1, cubic = segments[i]
+        mask = idx == i
+        result[mask] = eval_cubic(cubic, (ts[mask] - t0) / (t1 - t0))
+    return result
+
+def cubics_tangent(segments, t):
+    t0, t1, cubic = segments[_locate(segments, [t])[0]]
+    return cubic_derivative(cubic, [(t - t0) / (t1 - t0)])[0] / (t1 - t0)
@@ -1,5 +1,5 @@
 import numpy as np
-from utils.algorithms import de_casteljau, calc_tangent
+from utils.algorithms import de_casteljau, approximate_cubics, eval_cubics, cubics_tangent
 
 def draw(app):
     ax = app.ax
@@ -24,11 +24,10 @@ def draw(app):
             ax.text(*mid, f"{length:.2f}", fontsize=10, color='purple')
 
     if app.show_curve.get() and len(app.points) >= 2:
-        ts = np.linspace(0, 1, 200)
-        curve = [de_casteljau(app.points, t)[0] for t in ts]
-        xs, ys = zip(*curve)
-        ax.plot(xs, ys, 'b', label='Bézier görbe')
-        pt = de_casteljau(app.points, app.t_slider.get())[0]
+        cubics = approximate_cubics(app.points)
+        curve = eval_cubics(cubics, np.linspace(0, 1, 200))
+        ax.plot(curve[:, 0], curve[:, 1], 'b', label='Bézier görbe')
+        pt = eval_cubics(cubics, [app.t_slider.get()])[0]
         ax.plot(pt[0], pt[1], 'ro', label=f'P(t={app.t_slider.get():.2f})')
 
     if app.show_helpers.get():
@@ -40,11 +39,11 @@ def draw(app):
             ax.plot(xs, ys, 'o--')
 
     if app.show_tangent.get() and len(app.points) >= 2:
-        tangent = calc_tangent(app.points, app.t_slider.get())
-        if tangent is not None:
-            pt = de_casteljau(app.points, app.t_slider.get())[0]
-            norm = tangent / np.linalg.norm(tangent) * 0.07
-            ax.arrow(pt[0], pt[1], norm[0], norm[1], color='green', head_width=0.01, label='Tangens')
+        cubics = approximate_cubics(app.points)
+        tangent = cubics_tangent(cubics, app.t_slider.get())
+        pt = eval_cubics(cubics, [app.t_slider.get()])[0]
+        norm = tangent / np.linalg.norm(tangent) * 0.07
+        ax.arrow(pt[0], pt[1], norm[0], norm[1], color='green', head_width=0.01, label='Tangens')
 
     ax.legend()
     app.canvas.draw()
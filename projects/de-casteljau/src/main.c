@@ -6,6 +6,10 @@
 const double POINT_RADIUS = 10.0;
 const int N_POINTS = 4;
 const int NUM_CURVE_POINTS = 100; // Pontok száma a Bezier görbén
+const double CUBIC_TOLERANCE = 0.5; // Megengedett eltérés pixelben a köbös közelítésnél
+const int CUBIC_ERROR_SAMPLES = 8;
+#define MAX_SUBDIVISION_DEPTH 10
+#define MAX_CUBIC_SEGMENTS (1 << MAX_SUBDIVISION_DEPTH)
 
 typedef struct Point {
     double x;
@@ -19,6 +23,110 @@ Point lerp(Point a, Point b, double t) {
     return result;
 }
 
+typedef struct CubicSegment {
+    double t0;
+    double t1;
+    Point p[4];
+} CubicSegment;
+
+typedef struct CubicCache {
+    CubicSegment segments[MAX_CUBIC_SEGMENTS];
+    int count;
+    bool valid;
+} CubicCache;
+
+Point evalBezier(Point* points, int numPoints, double t) {
+    Point tempPoints[numPoints];
+    for (int i = 0; i < numPoints; ++i) {
+        tempPoints[i] = points[i];
+    }
+    for (int k = numPoints - 1; k > 0; --k) {
+        for (int i = 0; i < k; ++i) {
+            tempPoints[i] = lerp(tempPoints[i], tempPoints[i + 1], t);
+        }
+    }
+    return tempPoints[0];
+}
+
+void subdivideBezier(Point* points, int numPoints, double t, Point* left, Point* right) {
+    Point tempPoints[numPoints];
+    for (int i = 0; i < numPoints; ++i) {
+        tempPoints[i] = points[i];
+    }
+    left[0] = tempPoints[0];
+    right[numPoints - 1] = tempPoints[numPoints - 1];
+    for (int k = numPoints - 1; k > 0; --k) {
+        for (int i = 0; i < k; ++i) {
+            tempPoints[i] = lerp(tempPoints[i], tempPoints[i + 1], t);
+        }
+        left[numPoints - k] = tempPoints[0];
+        right[k - 1] = tempPoints[k - 1];
+    }
+}
+
+// A végpontok és a végponti deriváltak (n * (b1 - b0)) megmaradnak, n <= 3 esetén pontos
+void reduceToCubic(Point* points, int numPoints, Point* cubic) {
+    double scale = (numPoints - 1) / 3.0;
+    cubic[0] = points[0];
+    cubic[1] = lerp(points[0], points[1], scale);
+    cubic[2] = lerp(points[numPoints - 1], points[numPoints - 2], scale);
+    cubic[3] = points[numPoints - 1];
+}
+
+Point evalCubic(Point* cubic, double t) {
+    double s = 1 - t;
+    double b0 = s * s * s;
+    double b1 = 3 * s * s * t;
+    double b2 = 3 * s * t * t;
+    double b3 = t * t * t;
+    Point result;
+    result.x = b0 * cubic[0].x + b1 * cubic[1].x + b2 * cubic[2].x + b3 * cubic[3].x;
+    result.y = b0 * cubic[0].y + b1 * cubic[1].y + b2 * cubic[2].y + b3 * cubic[3].y;
+    return result;
+}
+
+double cubicError(Point* points, int numPoints, Point* cubic) {
+    double maxError = 0.0;
+    for (int i = 1; i < CUBIC_ERROR_SAMPLES; ++i) {
+        double t = (double)i / CUBIC_ERROR_SAMPLES;
+        Point a = evalBezier(points, numPoints, t);
+        Point b = evalCubic(cubic, t);
+        double dx = a.x - b.x;
+        double dy = a.y - b.y;
+        double error = sqrt(dx * dx + dy * dy);
+        if (error > maxError) maxError = error;
+    }
+    return maxError;
+}
+
+void approximateCubics(CubicCache* cache, Point* points, int numPoints, double t0, double t1, int depth) {
+    Point cubic[4];
+    reduceToCubic(points, numPoints, cubic);
+    if (numPoints > 4 && depth < MAX_SUBDIVISION_DEPTH && cubicError(points, numPoints, cubic) > CUBIC_TOLERANCE) {
+        Point left[numPoints];
+        Point right[numPoints];
+        double mid = (t0 + t1) / 2;
+        subdivideBezier(points, numPoints, 0.5, left, right);
+        approximateCubics(cache, left, numPoints, t0, mid, depth + 1);
+        approximateCubics(cache, right, numPoints, mid, t1, depth + 1);
+        return;
+    }
+    CubicSegment* segment = cache->segments + cache->count++;
+    segment->t0 = t0;
+    segment->t1 = t1;
+    for (int i = 0; i < 4; ++i) {
+        segment->p[i] = cubic[i];
+    }
+}
+
+// Csak akkor számol újra, ha egy kontrollpont megváltozott
+void updateCubicCache(CubicCache* cache, Point* points, int numPoints) {
+    if (cache->valid) return;
+    cache->count = 0;
+    approximateCubics(cache, points, numPoints, 0.0, 1.0, 0);
+    cache->valid = true;
+}
+
 void drawAuxiliaryLines(SDL_Renderer* renderer, Point* points, int numPoints, double t) {
     Point tempPoints[numPoints];
     for (int i = 0; i < numPoints; ++i) {
@@ -33,21 +141,16 @@ void drawAuxiliaryLines(SDL_Renderer* renderer, Point* points, int numPoints, do
     }
 }
 
-void drawBezierCurve(SDL_Renderer* renderer, Point* points, int numPoints) {
+void drawBezierCurve(SDL_Renderer* renderer, CubicCache* cache) {
     SDL_SetRenderDrawColor(renderer, 0, 255, 0, SDL_ALPHA_OPAQUE);
-    Point prevPoint = points[0];
+    CubicSegment* segment = cache->segments;
+    Point prevPoint = segment->p[0];
     for (int i = 1; i < NUM_CURVE_POINTS; ++i) {
         double t = (double)i / (NUM_CURVE_POINTS - 1);
-        Point tempPoints[numPoints];
-        for (int j = 0; j < numPoints; ++j) {
-            tempPoints[j] = points[j];
-        }
-        for (int k = numPoints - 1; k > 0; --k) {
-            for (int j = 0; j < k; ++j) {
-                tempPoints[j] = lerp(tempPoints[j], tempPoints[j + 1], t);
-            }
+        while (t > segment->t1 && segment < cache->segments + cache->count - 1) {
+            ++segment;
         }
-        Point currentPoint = tempPoints[0];
+        Point currentPoint = evalCubic(segment->p, (t - segment->t0) / (segment->t1 - segment->t0));
         SDL_RenderDrawLine(renderer, prevPoint.x, prevPoint.y, currentPoint.x, currentPoint.y);
         prevPoint = currentPoint;
     }
@@ -64,6 +167,7 @@ int main(int argc, char* argv[]) {
     int i;
     Point* selected_point = NULL;
     Point points[N_POINTS];
+    static CubicCache cubic_cache;
     points[0].x = 200;
     points[0].y = 200;
     points[1].x = 400;
@@ -102,6 +206,7 @@ int main(int argc, char* argv[]) {
                         SDL_GetMouseState(&mouse_x, &mouse_y);
                         selected_point->x = mouse_x;
                         selected_point->y = mouse_y;
+                        cubic_cache.valid = false;
                     }
                     break;
                 case SDL_MOUSEBUTTONUP:
@@ -138,7 +243,8 @@ int main(int argc, char* argv[]) {
         }
 
         drawAuxiliaryLines(renderer, points, N_POINTS, t);
-        drawBezierCurve(renderer, points, N_POINTS);
+        updateCubicCache(&cubic_cache, points, N_POINTS);
+        drawBezierCurve(renderer, &cubic_cache);
 
         SDL_RenderPresent(renderer);
     }